@@ -203,6 +203,8 @@ int main(void)
 	  DBG_println("Day: %d, Weekday: %d, month: %d, year: %d",
 			  current_date.day, current_date.weekday, current_date.month, current_date.year);
 
+	  DBG_flush();
+
 	  HAL_Delay(1000);
     /* USER CODE END WHILE */
 
@@ -254,10 +256,10 @@ void SystemClock_Config(void)
 #if 0
 void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
 {
-	DBG_println("a");
+	DBG_log("a");
 
 	if (INT_Pin == GPIO_Pin) {
-		DBG_println("here!");
+		DBG_log("here!");
 		pcf_alarm = true;
 	}
 }
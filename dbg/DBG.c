@@ -4,10 +4,12 @@
 
 #include "printf.h"
 #include "hexdump.h"
+#include "DBG_queue.h"
 
 #include "usart.h"
 
 static UART_HandleTypeDef *DBG_UART_PORT = NULL;
+static dbg_queue_t DBG_QUEUE;
 
 void _putchar(char character)
 {
@@ -44,24 +46,75 @@ void DBG_print(const char *fmt, ...)
 }
 
 /**
- * Dump a block of data as hexadecimal and ASCII to the provided stream.
- * @tparam addrT        Address type. This type determines the amount of digits displayed for
- *                      the address, e.g. size_t to leave it up to the architecture or uint8_t
- *                      to use only a single byte.
- * @tparam bytesPerRow  Number of bytes to print per row, e.g. 16 or 8.
- * @param  stream       Output stream (e.g. Serial) to print to.
+ * Queue a line for DBG_flush, safe to call from interrupt handlers.
+ * The message is formatted straight into a reserved record, lines longer
+ * than DBG_QUEUE_RECORD_SIZE are truncated and lines logged while the
+ * queue is full are dropped.
+ */
+void DBG_log(const char *fmt, ...)
+{
+	dbg_queue_record_t *record = DBG_queue_reserve(&DBG_QUEUE);
+
+	if (NULL == record) {
+		return;
+	}
+
+	va_list args;
+	va_start(args, fmt);
+	int len = vsnprintf(record->data, DBG_QUEUE_RECORD_SIZE - 1, fmt, args);
+	va_end(args);
+
+	/* vsnprintf returns the untruncated length */
+	if (len < 0) {
+		len = 0;
+	} else if (len > (DBG_QUEUE_RECORD_SIZE - 2)) {
+		len = DBG_QUEUE_RECORD_SIZE - 2;
+	}
+
+	record->data[len++] = '\r';
+	record->data[len++] = '\n';
+	DBG_queue_commit(&DBG_QUEUE, record, len);
+}
+
+/**
+ * Transmit the lines queued by DBG_log, call it from the main loop only.
+ * @return Number of lines dropped since DBG_init because the queue was full.
+ */
+unsigned int DBG_flush(void)
+{
+	char line[DBG_QUEUE_RECORD_SIZE];
+	size_t len;
+
+	while (DBG_queue_pop(&DBG_QUEUE, line, &len)) {
+		DBG_write(line, len);
+	}
+
+	return DBG_queue_dropped(&DBG_QUEUE);
+}
+
+void DBG_write(const char *data, size_t len)
+{
+	HAL_UART_Transmit(DBG_UART_PORT, (uint8_t *) data, len, 250);
+}
+
+/**
+ * Dump a block of data as hexadecimal and ASCII, 16 bytes per row with a
+ * 16 bit address. Every line is rendered in RAM and sent in one transfer.
  * @param  buff         Ptr to block of data to print.
  * @param  len          Length of block to print, in [bytes].
  * @param  base         Optional address offset to use in priting.
 */
 void DBG_hexdump(uint8_t *buff, size_t len, size_t base)
 {
-	char *header = "\r\n      00 01 02 03 04 05 06 07 08 09 0A 0B 0C 0D 0E 0F\r\n";
-	char *header_sep = "      -----------------------------------------------\r\n";
+	const hexdump_conf_t conf = {
+		.bytes_per_row = HEXDUMP_DEFAULT_BYTES_PER_ROW,
+		.addr_digits = HEXDUMP_DEFAULT_ADDR_DIGITS,
+	};
+	char line[HEXDUMP_ROW_SIZE];
 
-        DBG_print(header);
-        DBG_print(header_sep);
+	DBG_write("\r\n", strlen("\r\n"));
+	DBG_write(line, HexDump_format_header(line, &conf));
+	DBG_write(line, HexDump_format_separator(line, &conf));
 	HexDump(buff, len, base);
-        DBG_print("\r\n");
+	DBG_write("\r\n", strlen("\r\n"));
 }
-
@@ -16,6 +16,9 @@ void DBG_init(void *handle);
 void DBG_clear_screen(void);
 void DBG_println(const char *fmt, ...);
 void DBG_print(const char *fmt, ...);
+void DBG_write(const char *data, size_t len);
+void DBG_log(const char *fmt, ...);
+unsigned int DBG_flush(void);
 void DBG_hexdump(uint8_t *buff, size_t len, size_t base);
 
 #ifdef __cplusplus
@@ -0,0 +1,110 @@
+#include <string.h>
+
+#include "DBG_queue.h"
+
+#define DBG_QUEUE_MASK	(DBG_QUEUE_RECORDS - 1)
+
+void DBG_queue_init(dbg_queue_t *queue)
+{
+	for (unsigned int i = 0; i < DBG_QUEUE_RECORDS; i++) {
+		atomic_init(&queue->records[i].seq, i);
+		queue->records[i].len = 0;
+	}
+
+	atomic_init(&queue->tail, 0);
+	atomic_init(&queue->dropped, 0);
+	queue->head = 0;
+}
+
+/**
+ * Claim the next free record, safe to call from any context.
+ * On Cortex-M the compare-and-swap compiles to LDREX/STREX, an exception
+ * taken between them clears the reservation and the loop retries with the
+ * tail the interrupting producer left behind.
+ * @return Record to fill and pass to DBG_queue_commit, NULL if the queue is full.
+ */
+dbg_queue_record_t *DBG_queue_reserve(dbg_queue_t *queue)
+{
+	unsigned int pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+
+	for (;;) {
+		dbg_queue_record_t *record = &queue->records[pos & DBG_QUEUE_MASK];
+		unsigned int seq = atomic_load_explicit(&record->seq, memory_order_acquire);
+		int diff = (int) (seq - pos);
+
+		if (0 == diff) {
+			if (atomic_compare_exchange_weak_explicit(&queue->tail, &pos, pos + 1,
+					memory_order_relaxed, memory_order_relaxed)) {
+				return record;
+			}
+			/* pos was reloaded by the failed exchange */
+		} else if (diff < 0) {
+			/* the consumer has not released this record yet */
+			atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed);
+			return NULL;
+		} else {
+			pos = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+		}
+	}
+}
+
+/**
+ * Publish a record obtained from DBG_queue_reserve.
+ * @param len Bytes written to record->data, clamped to DBG_QUEUE_RECORD_SIZE.
+ */
+void DBG_queue_commit(dbg_queue_t *queue, dbg_queue_record_t *record, size_t len)
+{
+	(void) queue;
+
+	unsigned int pos = atomic_load_explicit(&record->seq, memory_order_relaxed);
+
+	record->len = (uint16_t) (len < DBG_QUEUE_RECORD_SIZE ? len : DBG_QUEUE_RECORD_SIZE);
+	atomic_store_explicit(&record->seq, pos + 1, memory_order_release);
+}
+
+bool DBG_queue_push(dbg_queue_t *queue, const char *data, size_t len)
+{
+	dbg_queue_record_t *record = DBG_queue_reserve(queue);
+
+	if (NULL == record) {
+		return false;
+	}
+
+	len = len < DBG_QUEUE_RECORD_SIZE ? len : DBG_QUEUE_RECORD_SIZE;
+	memcpy(record->data, data, len);
+	DBG_queue_commit(queue, record, len);
+
+	return true;
+}
+
+/**
+ * Take the oldest record, only one context may consume.
+ * A record reserved but not yet committed blocks the ones behind it until
+ * its producer finishes.
+ * @param out Destination of at least DBG_QUEUE_RECORD_SIZE bytes.
+ * @param len Length of the record.
+ * @return false if no record is ready.
+ */
+bool DBG_queue_pop(dbg_queue_t *queue, char *out, size_t *len)
+{
+	const unsigned int pos = queue->head;
+	dbg_queue_record_t *record = &queue->records[pos & DBG_QUEUE_MASK];
+	unsigned int seq = atomic_load_explicit(&record->seq, memory_order_acquire);
+
+	if (seq != (pos + 1)) {
+		return false;
+	}
+
+	*len = record->len;
+	memcpy(out, record->data, *len);
+
+	queue->head = pos + 1;
+	atomic_store_explicit(&record->seq, pos + DBG_QUEUE_RECORDS, memory_order_release);
+
+	return true;
+}
+
+unsigned int DBG_queue_dropped(dbg_queue_t *queue)
+{
+	return atomic_load_explicit(&queue->dropped, memory_order_relaxed);
+}
@@ -0,0 +1,63 @@
+#ifndef DBG_QUEUE_H_
+#define DBG_QUEUE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/* Number of records, must be a power of two */
+#ifndef DBG_QUEUE_RECORDS
+#define DBG_QUEUE_RECORDS		16
+#endif
+
+/* Payload bytes per record, longer messages are truncated */
+#ifndef DBG_QUEUE_RECORD_SIZE
+#define DBG_QUEUE_RECORD_SIZE	64
+#endif
+
+#if (DBG_QUEUE_RECORDS & (DBG_QUEUE_RECORDS - 1)) != 0
+#error "DBG_QUEUE_RECORDS must be a power of two"
+#endif
+
+typedef struct {
+	/* Sequence number: equal to the position when free, position + 1 when committed */
+	atomic_uint seq;
+	uint16_t len;
+	char data[DBG_QUEUE_RECORD_SIZE];
+} dbg_queue_record_t;
+
+/*
+ * Bounded multi-producer, single-consumer queue of fixed size records.
+ *
+ * Producers (main loop and any number of interrupt priorities) claim a whole
+ * record with one compare-and-swap on the tail, fill it in place and publish
+ * it, without disabling interrupts or ever waiting on another producer. When
+ * the queue is full the record is dropped and counted. The single consumer
+ * drains records in reservation order.
+ */
+typedef struct {
+	atomic_uint tail;	/* next position to reserve, shared by the producers */
+	unsigned int head;	/* next position to pop, owned by the consumer */
+	atomic_uint dropped;
+	dbg_queue_record_t records[DBG_QUEUE_RECORDS];
+} dbg_queue_t;
+
+void DBG_queue_init(dbg_queue_t *queue);
+
+dbg_queue_record_t *DBG_queue_reserve(dbg_queue_t *queue);
+void DBG_queue_commit(dbg_queue_t *queue, dbg_queue_record_t *record, size_t len);
+bool DBG_queue_push(dbg_queue_t *queue, const char *data, size_t len);
+
+bool DBG_queue_pop(dbg_queue_t *queue, char *out, size_t *len);
+unsigned int DBG_queue_dropped(dbg_queue_t *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DBG_QUEUE_H_ */
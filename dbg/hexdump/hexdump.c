@@ -1,96 +1,267 @@
-#include <stdio.h>
 #include <string.h>
-#include <ctype.h>
 
 #include "hexdump.h"
 
 #include "DBG.h"
 
+static const hexdump_conf_t default_conf = {
+    .bytes_per_row = HEXDUMP_DEFAULT_BYTES_PER_ROW,
+    .addr_digits = HEXDUMP_DEFAULT_ADDR_DIGITS,
+};
+
+/**
+ * Convert the four nibbles of a 16 bit value to ASCII hex digits in one go
+ * (SIMD within a register), most significant nibble first.
+ * @param  out  Destination of the 4 digits.
+ * @param  val  Value to convert.
+ */
+static inline void SwarHex16(char *out, const uint16_t val)
+{
+    // Spread one nibble per byte, most significant nibble in the lowest byte
+    uint32_t x = ((uint32_t) (val >> 12) & 0x0F)
+            | (((uint32_t) (val >> 8) & 0x0F) << 8)
+            | (((uint32_t) (val >> 4) & 0x0F) << 16)
+            | (((uint32_t) val & 0x0F) << 24);
+    // 0x01 in every byte whose nibble is >= 10
+    const uint32_t letters = ((x + 0x06060606UL) >> 4) & 0x01010101UL;
+    x += 0x30303030UL + (letters * ('A' - '0' - 10));
+
+    out[0] = (char) x;
+    out[1] = (char) (x >> 8);
+    out[2] = (char) (x >> 16);
+    out[3] = (char) (x >> 24);
+}
+
+static char *PutAddr(char *out, size_t addr, const uint8_t digits)
+{
+    char hex[HEXDUMP_MAX_ADDR_DIGITS];
+    const uint32_t val = (uint32_t) addr;
+
+    SwarHex16(&hex[0], (uint16_t) (val >> 16));
+    SwarHex16(&hex[4], (uint16_t) val);
+
+    memcpy(out, &hex[HEXDUMP_MAX_ADDR_DIGITS - digits], digits);
+    return out + digits;
+}
+
+static int IsGraph(const uint8_t c)
+{
+    return (0x21 <= c) && (c <= 0x7E);
+}
+
+static void CheckConf(const hexdump_conf_t *conf)
+{
+    HEXDUMP_ASSERT(conf);
+    HEXDUMP_ASSERT((0 < conf->bytes_per_row) && (conf->bytes_per_row <= HEXDUMP_MAX_BYTES_PER_ROW));
+    HEXDUMP_ASSERT((0 < conf->addr_digits) && (conf->addr_digits <= HEXDUMP_MAX_ADDR_DIGITS));
+}
+
 /**
- * Print a single hexadecimal value to the provided stream.
- * The value will be prefixed by zeroes, when required, to force the
- * number of output digits to the 2 times the size of the valueT.
- * @tparam valueT  Type of value to be printed, e.g. size_t or uint8_t.
- * @param  stream  Output stream (e.g. Serial) to print to.
- * @param  val     Value to print as hexadecimal.
+ * Render the column header, e.g. "      00 01 .. 0F\r\n".
+ * @param  out   Destination, at least HEXDUMP_ROW_SIZE bytes.
+ * @param  conf  Row layout.
+ * @return Length of the header, not NULL terminated.
  */
-static void PrintHex(const uint8_t val)
+size_t HexDump_format_header(char *out, const hexdump_conf_t *conf)
 {
-    const uint8_t digits = sizeof(uint8_t) << 1;
-    uint8_t i = 0;
-    
-    while (i < digits) {
-        // Each nibble stores 1 digit
-        uint8_t v = (val >> ((digits - i - 1) << 2)) & 0x0F;
-        DBG_print("%X", v);
-        ++i;
+    CheckConf(conf);
+
+    char *p = out;
+    memset(p, ' ', conf->addr_digits + 2);
+    p += conf->addr_digits + 2;
+
+    for (uint8_t c = 0; c < conf->bytes_per_row; ++c) {
+        char hex[4];
+        SwarHex16(hex, c);
+        *p++ = hex[2];
+        *p++ = hex[3];
+        *p++ = ' ';
     }
+
+    // no trailing space after the last column
+    p[-1] = '\r';
+    *p++ = '\n';
+
+    return (size_t) (p - out);
+}
+
+/**
+ * Render the line under the header, e.g. "      -----\r\n".
+ * @param  out   Destination, at least HEXDUMP_ROW_SIZE bytes.
+ * @param  conf  Row layout.
+ * @return Length of the separator, not NULL terminated.
+ */
+size_t HexDump_format_separator(char *out, const hexdump_conf_t *conf)
+{
+    CheckConf(conf);
+
+    char *p = out;
+    memset(p, ' ', conf->addr_digits + 2);
+    p += conf->addr_digits + 2;
+    memset(p, '-', (conf->bytes_per_row * 3) - 1);
+    p += (conf->bytes_per_row * 3) - 1;
+    *p++ = '\r';
+    *p++ = '\n';
+
+    return (size_t) (p - out);
 }
 
-static void PrintDir(const uint16_t val)
+/**
+ * Render a single row "AAAA: XX XX ..  |ascii|\r\n" into a buffer.
+ * Missing bytes of a short last row are padded with spaces.
+ * @param  out   Destination, at least HEXDUMP_ROW_SIZE bytes.
+ * @param  conf  Row layout.
+ * @param  data  Bytes of the row.
+ * @param  len   Number of bytes, at most conf->bytes_per_row.
+ * @param  addr  Address printed for the first byte.
+ * @return Length of the row, not NULL terminated.
+ */
+size_t HexDump_format_row(char *out, const hexdump_conf_t *conf,
+        const uint8_t *data, size_t len, size_t addr)
 {
-    const uint8_t digits = sizeof(uint16_t) << 1;
-    uint8_t i = 0;
-    
-    while (i < digits) {
-        // Each nibble stores 1 digit
-        uint8_t v = (val >> ((digits - i - 1) << 2)) & 0x0F;
-        DBG_print("%X", v);
-        ++i;
+    CheckConf(conf);
+    HEXDUMP_ASSERT(len <= conf->bytes_per_row);
+
+    char *p = PutAddr(out, addr, conf->addr_digits);
+    *p++ = ':';
+    *p++ = ' ';
+
+    // two bytes per conversion
+    size_t c = 0;
+    for (; (c + 1) < len; c += 2) {
+        char hex[4];
+        SwarHex16(hex, (uint16_t) ((data[c] << 8) | data[c + 1]));
+        p[0] = hex[0];
+        p[1] = hex[1];
+        p[2] = ' ';
+        p[3] = hex[2];
+        p[4] = hex[3];
+        p[5] = ' ';
+        p += 6;
+    }
+    if (c < len) {
+        char hex[4];
+        SwarHex16(hex, data[c]);
+        p[0] = hex[2];
+        p[1] = hex[3];
+        p[2] = ' ';
+        p += 3;
     }
+
+    const size_t pad = (conf->bytes_per_row - len) * 3;
+    memset(p, ' ', pad);
+    p += pad;
+
+    *p++ = ' ';
+    *p++ = '|';
+    for (c = 0; c < len; ++c) {
+        *p++ = IsGraph(data[c]) ? (char) data[c] : '.';
+    }
+    *p++ = '|';
+    *p++ = '\r';
+    *p++ = '\n';
+
+    return (size_t) (p - out);
 }
 
 /**
- * Dump a block of data as hexadecimal and ASCII to the provided stream.
- * @tparam addrT        Address type. This type determines the amount of digits displayed for
- *                      the address, e.g. size_t to leave it up to the architecture or uint8_t
- *                      to use only a single byte.
- * @tparam bytesPerRow  Number of bytes to print per row, e.g. 16 or 8.
- * @param  stream       Output stream (e.g. Serial) to print to.
+ * Start a streaming dump, the data can then be fed in chunks of any size.
+ * @param  stream  Stream state.
+ * @param  conf    Row layout, NULL for the default 16 bytes and 4 address digits.
+ * @param  write   Sink called with every complete row.
+ * @param  ctx     User context for the sink.
+ * @param  base    Address of the first byte.
+ */
+void HexDump_stream_init(hexdump_stream_t *stream, const hexdump_conf_t *conf,
+        hexdump_write write, void *ctx, size_t base)
+{
+    HEXDUMP_ASSERT(stream);
+    HEXDUMP_ASSERT(write);
+
+    stream->conf = conf ? *conf : default_conf;
+    CheckConf(&stream->conf);
+
+    stream->write = write;
+    stream->ctx = ctx;
+    stream->addr = base;
+    stream->fill = 0;
+}
+
+void HexDump_stream_write(hexdump_stream_t *stream, const uint8_t *data, size_t len)
+{
+    HEXDUMP_ASSERT(stream);
+
+    char row[HEXDUMP_ROW_SIZE];
+    const uint8_t bytes_per_row = stream->conf.bytes_per_row;
+
+    // complete a partially buffered row first
+    if (stream->fill) {
+        size_t n = bytes_per_row - stream->fill;
+        n = len < n ? len : n;
+        memcpy(&stream->row[stream->fill], data, n);
+        stream->fill += n;
+        data += n;
+        len -= n;
+
+        if (stream->fill < bytes_per_row) {
+            return;
+        }
+
+        stream->write(row, HexDump_format_row(row, &stream->conf,
+                stream->row, bytes_per_row, stream->addr), stream->ctx);
+        stream->addr += bytes_per_row;
+        stream->fill = 0;
+    }
+
+    // whole rows are rendered straight from the caller data
+    while (len >= bytes_per_row) {
+        stream->write(row, HexDump_format_row(row, &stream->conf,
+                data, bytes_per_row, stream->addr), stream->ctx);
+        stream->addr += bytes_per_row;
+        data += bytes_per_row;
+        len -= bytes_per_row;
+    }
+
+    memcpy(stream->row, data, len);
+    stream->fill = len;
+}
+
+/**
+ * Emit the last, short, row of a streaming dump.
+ */
+void HexDump_stream_flush(hexdump_stream_t *stream)
+{
+    HEXDUMP_ASSERT(stream);
+
+    if (stream->fill) {
+        char row[HEXDUMP_ROW_SIZE];
+        stream->write(row, HexDump_format_row(row, &stream->conf,
+                stream->row, stream->fill, stream->addr), stream->ctx);
+        stream->addr += stream->fill;
+        stream->fill = 0;
+    }
+}
+
+static void DbgWrite(const char *data, size_t len, void *ctx)
+{
+    (void) ctx;
+    DBG_write(data, len);
+}
+
+/**
+ * Dump a block of data as hexadecimal and ASCII to the debug port, one
+ * write per row of 16 bytes with a 16 bit address.
  * @param  buff         Ptr to block of data to print.
  * @param  len          Length of block to print, in [bytes].
  * @param  base         Optional address offset to use in priting.
 */
 void HexDump(uint8_t *buff, size_t len, size_t base)
 {
-    const uint8_t bytesPerRow = 16;
-    const size_t rows = (len + bytesPerRow - 1) / bytesPerRow;
-    uint8_t *p = buff;
-
-    for (size_t r = 0; r < rows; ++r) {
-        // imprime las direcciones
-        PrintDir(base + p - buff);
-        DBG_print(": ");
-
-        char *pc = (char *) p;
-        const size_t cols = len < bytesPerRow ? len : bytesPerRow;
-        
-        // impresion de bytes
-        for (size_t c = 0; c < bytesPerRow; ++c) {
-            if (c < cols) {
-                PrintHex(*p++);
-            } else {
-                DBG_print("  ");
-            }
-            
-            DBG_print(" ");
-        }
-        
-        DBG_print(" |");
-        
-        // impresion de ascii
-        for (size_t i = 0; i < cols; ++i) {
-            char c = *pc++;
-            if (isgraph(c)) {
-                DBG_print(&c);
-            } else {
-                DBG_print(".");
-            }
-        }
-        
-        DBG_print("|\r\n");
-        len -= bytesPerRow;
-    }
+    hexdump_stream_t stream;
+
+    HexDump_stream_init(&stream, NULL, DbgWrite, NULL, base);
+    HexDump_stream_write(&stream, buff, len);
+    HexDump_stream_flush(&stream);
 }
 
 /* [] END OF FILE */
@@ -12,6 +12,51 @@ extern "C" {
 #include <stdint.h>
 #include <stddef.h>
 
+#ifndef HEXDUMP_ASSERT
+#define HEXDUMP_ASSERT(x) do { if (!(x)) { while(1); } } while (0)
+#endif
+
+#define HEXDUMP_DEFAULT_BYTES_PER_ROW   16
+#define HEXDUMP_DEFAULT_ADDR_DIGITS     4
+
+#define HEXDUMP_MAX_BYTES_PER_ROW       32
+#define HEXDUMP_MAX_ADDR_DIGITS         8
+
+// "AAAA: XX XX ..  |ascii|\r\n"
+#define HEXDUMP_ROW_SIZE    (HEXDUMP_MAX_ADDR_DIGITS + 2 + (HEXDUMP_MAX_BYTES_PER_ROW * 4) + 5)
+
+/**
+ * Sink for the formatted rows, called once per row.
+ * @param  data  Row text, not NULL terminated.
+ * @param  len   Length of the row text.
+ * @param  ctx   User context given to HexDump_stream_init.
+ */
+typedef void (*hexdump_write)(const char *data, size_t len, void *ctx);
+
+typedef struct {
+    uint8_t bytes_per_row;  // 1..HEXDUMP_MAX_BYTES_PER_ROW
+    uint8_t addr_digits;    // 1..HEXDUMP_MAX_ADDR_DIGITS, the address is truncated to them
+} hexdump_conf_t;
+
+typedef struct {
+    hexdump_conf_t  conf;
+    hexdump_write   write;
+    void            *ctx;
+    size_t          addr;   // address of the first byte in row
+    uint8_t         fill;   // bytes buffered in row
+    uint8_t         row[HEXDUMP_MAX_BYTES_PER_ROW];
+} hexdump_stream_t;
+
+size_t HexDump_format_header(char *out, const hexdump_conf_t *conf);
+size_t HexDump_format_separator(char *out, const hexdump_conf_t *conf);
+size_t HexDump_format_row(char *out, const hexdump_conf_t *conf,
+        const uint8_t *data, size_t len, size_t addr);
+
+void HexDump_stream_init(hexdump_stream_t *stream, const hexdump_conf_t *conf,
+        hexdump_write write, void *ctx, size_t base);
+void HexDump_stream_write(hexdump_stream_t *stream, const uint8_t *data, size_t len);
+void HexDump_stream_flush(hexdump_stream_t *stream);
+
 void HexDump(uint8_t *buff, size_t len, size_t base);
 
 #ifdef __cplusplus
@@ -82,6 +82,23 @@
 #define PRINTF_MAX_FLOAT  1e9
 #endif
 
+// use single precision (float) arithmetic for %f/%e/%g instead of double
+// variadic arguments are still passed as double, but are narrowed to float once
+// on entry so that MCUs with a single-precision FPU avoid software double math
+// the output is then exact to about 7 significant digits
+// default: deactivated
+#ifdef PRINTF_ENABLE_SUPPORT_SINGLE_PRECISION
+#define PRINTF_SUPPORT_SINGLE_PRECISION
+#endif
+
+// print %g/%G without an explicit precision as the shortest decimal string that
+// round-trips to the same float value (Ryu algorithm), e.g. 0.1f -> "0.1"
+// requires single precision support
+// default: deactivated
+#ifdef PRINTF_ENABLE_SUPPORT_SHORTEST_ROUNDTRIP
+#define PRINTF_SUPPORT_SHORTEST_ROUNDTRIP
+#endif
+
 // support for the long long types (%llu or %p)
 // default: activated
 #ifndef PRINTF_DISABLE_SUPPORT_LONG_LONG
@@ -97,29 +114,48 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
-// internal flag definitions
-#define FLAGS_ZEROPAD   (1U <<  0U)
-#define FLAGS_LEFT      (1U <<  1U)
-#define FLAGS_PLUS      (1U <<  2U)
-#define FLAGS_SPACE     (1U <<  3U)
-#define FLAGS_HASH      (1U <<  4U)
-#define FLAGS_UPPERCASE (1U <<  5U)
-#define FLAGS_CHAR      (1U <<  6U)
-#define FLAGS_SHORT     (1U <<  7U)
-#define FLAGS_LONG      (1U <<  8U)
-#define FLAGS_LONG_LONG (1U <<  9U)
-#define FLAGS_PRECISION (1U << 10U)
-#define FLAGS_ADAPT_EXP (1U << 11U)
+// internal flag definitions, shared with the compile-time front end
+#define FLAGS_ZEROPAD   PRINTF_FLAGS_ZEROPAD
+#define FLAGS_LEFT      PRINTF_FLAGS_LEFT
+#define FLAGS_PLUS      PRINTF_FLAGS_PLUS
+#define FLAGS_SPACE     PRINTF_FLAGS_SPACE
+#define FLAGS_HASH      PRINTF_FLAGS_HASH
+#define FLAGS_UPPERCASE PRINTF_FLAGS_UPPERCASE
+#define FLAGS_CHAR      PRINTF_FLAGS_CHAR
+#define FLAGS_SHORT     PRINTF_FLAGS_SHORT
+#define FLAGS_LONG      PRINTF_FLAGS_LONG
+#define FLAGS_LONG_LONG PRINTF_FLAGS_LONG_LONG
+#define FLAGS_PRECISION PRINTF_FLAGS_PRECISION
+#define FLAGS_ADAPT_EXP PRINTF_FLAGS_ADAPT_EXP
 
 
 // import float.h for DBL_MAX
 #if defined(PRINTF_SUPPORT_FLOAT)
 #include <float.h>
+
+// floating point type used for the internal conversions
+#if defined(PRINTF_SUPPORT_SINGLE_PRECISION)
+typedef float floating_type;
+#define FLOATING_C(x)   x##f
+#define FLOATING_MAX    FLT_MAX
+#else
+typedef double floating_type;
+#define FLOATING_C(x)   x
+#define FLOATING_MAX    DBL_MAX
+#endif
+#endif  // PRINTF_SUPPORT_FLOAT
+
+#if defined(PRINTF_SUPPORT_SHORTEST_ROUNDTRIP) && !defined(PRINTF_SUPPORT_SINGLE_PRECISION)
+#error "PRINTF_ENABLE_SUPPORT_SHORTEST_ROUNDTRIP requires PRINTF_ENABLE_SUPPORT_SINGLE_PRECISION"
+#endif
+
+#if defined(PRINTF_SUPPORT_SHORTEST_ROUNDTRIP) && !defined(PRINTF_SUPPORT_EXPONENTIAL)
+#error "PRINTF_ENABLE_SUPPORT_SHORTEST_ROUNDTRIP requires exponential support"
 #endif
 
 
 // output function type
-typedef void (*out_fct_type)(char character, void* buffer, size_t idx, size_t maxlen);
+typedef printf_out_fct_type out_fct_type;
 
 
 // wrapper (used as buffer) for output function type
@@ -331,31 +367,31 @@ static size_t _ntoa_long_long(out_fct_type out, char* buffer, size_t idx, size_t
 
 #if defined(PRINTF_SUPPORT_EXPONENTIAL)
 // forward declaration so that _ftoa can switch to exp notation for values > PRINTF_MAX_FLOAT
-static size_t _etoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags);
+static size_t _etoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, floating_type value, unsigned int prec, unsigned int width, unsigned int flags);
 #endif
 
 
 // internal ftoa for fixed decimal floating point
-static size_t _ftoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags)
+static size_t _ftoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, floating_type value, unsigned int prec, unsigned int width, unsigned int flags)
 {
   char buf[PRINTF_FTOA_BUFFER_SIZE];
   size_t len  = 0U;
-  double diff = 0.0;
+  floating_type diff = FLOATING_C(0.0);
 
   // powers of 10
-  static const double pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+  static const floating_type pow10[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
 
   // test for special values
   if (value != value)
     return _out_rev(out, buffer, idx, maxlen, "nan", 3, width, flags);
-  if (value < -DBL_MAX)
+  if (value < -FLOATING_MAX)
     return _out_rev(out, buffer, idx, maxlen, "fni-", 4, width, flags);
-  if (value > DBL_MAX)
+  if (value > FLOATING_MAX)
     return _out_rev(out, buffer, idx, maxlen, (flags & FLAGS_PLUS) ? "fni+" : "fni", (flags & FLAGS_PLUS) ? 4U : 3U, width, flags);
 
   // test for very large values
   // standard printf behavior is to print EVERY whole number digit -- which could be 100s of characters overflowing your buffers == bad
-  if ((value > PRINTF_MAX_FLOAT) || (value < -PRINTF_MAX_FLOAT)) {
+  if ((value > (floating_type)PRINTF_MAX_FLOAT) || (value < -(floating_type)PRINTF_MAX_FLOAT)) {
 #if defined(PRINTF_SUPPORT_EXPONENTIAL)
     return _etoa(out, buffer, idx, maxlen, value, prec, width, flags);
 #else
@@ -381,11 +417,11 @@ static size_t _ftoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, d
   }
 
   int whole = (int)value;
-  double tmp = (value - whole) * pow10[prec];
+  floating_type tmp = (value - (floating_type)whole) * pow10[prec];
   unsigned long frac = (unsigned long)tmp;
-  diff = tmp - frac;
+  diff = tmp - (floating_type)frac;
 
-  if (diff > 0.5) {
+  if (diff > FLOATING_C(0.5)) {
     ++frac;
     // handle rollover, e.g. case 0.99 with prec 1 is 1.0
     if (frac >= pow10[prec]) {
@@ -393,7 +429,7 @@ static size_t _ftoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, d
       ++whole;
     }
   }
-  else if (diff < 0.5) {
+  else if (diff < FLOATING_C(0.5)) {
   }
   else if ((frac == 0U) || (frac & 1U)) {
     // if halfway, round up if odd OR if last digit is 0
@@ -401,8 +437,8 @@ static size_t _ftoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, d
   }
 
   if (prec == 0U) {
-    diff = value - (double)whole;
-    if ((!(diff < 0.5) || (diff > 0.5)) && (whole & 1)) {
+    diff = value - (floating_type)whole;
+    if ((!(diff < FLOATING_C(0.5)) || (diff > FLOATING_C(0.5))) && (whole & 1)) {
       // exactly 0.5 and ODD, then round up
       // 1.5 -> 2, but 2.5 -> 2
       ++whole;
@@ -463,14 +499,384 @@ static size_t _ftoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, d
 
 
 #if defined(PRINTF_SUPPORT_EXPONENTIAL)
+#if defined(PRINTF_SUPPORT_SINGLE_PRECISION)
+// powers of 10 from 1e-38 to 1e38, correctly rounded to float
+static const float _pow10f[] = {
+  1e-38f, 1e-37f, 1e-36f, 1e-35f, 1e-34f, 1e-33f, 1e-32f, 1e-31f, 1e-30f, 1e-29f,
+  1e-28f, 1e-27f, 1e-26f, 1e-25f, 1e-24f, 1e-23f, 1e-22f, 1e-21f, 1e-20f, 1e-19f,
+  1e-18f, 1e-17f, 1e-16f, 1e-15f, 1e-14f, 1e-13f, 1e-12f, 1e-11f, 1e-10f, 1e-09f,
+  1e-08f, 1e-07f, 1e-06f, 1e-05f, 1e-04f, 1e-03f, 1e-02f, 1e-01f, 1e+00f, 1e+01f,
+  1e+02f, 1e+03f, 1e+04f, 1e+05f, 1e+06f, 1e+07f, 1e+08f, 1e+09f, 1e+10f, 1e+11f,
+  1e+12f, 1e+13f, 1e+14f, 1e+15f, 1e+16f, 1e+17f, 1e+18f, 1e+19f, 1e+20f, 1e+21f,
+  1e+22f, 1e+23f, 1e+24f, 1e+25f, 1e+26f, 1e+27f, 1e+28f, 1e+29f, 1e+30f, 1e+31f,
+  1e+32f, 1e+33f, 1e+34f, 1e+35f, 1e+36f, 1e+37f, 1e+38f
+};
+#define POW10F_MIN_EXP  (-38)
+#define POW10F_MAX_EXP  (38)
+#endif  // PRINTF_SUPPORT_SINGLE_PRECISION
+
+
+#if defined(PRINTF_SUPPORT_SHORTEST_ROUNDTRIP)
+// Ryu shortest round-trip float to decimal conversion, see
+// Ulf Adams, "Ryu: fast float-to-string conversion", PLDI 2018
+// All arithmetic is done on 32/64-bit integers, no floating point is involved.
+#define RYU_FLOAT_MANTISSA_BITS   23
+#define RYU_FLOAT_BIAS            127
+#define RYU_POW5_INV_BITCOUNT     59
+#define RYU_POW5_BITCOUNT         61
+
+// ceil(2^(pow5bits(q) - 1 + 59) / 5^q)
+static const uint64_t _ryu_pow5_inv_split[31] = {
+  576460752303423489ULL, 461168601842738791ULL, 368934881474191033ULL,
+  295147905179352826ULL, 472236648286964522ULL, 377789318629571618ULL,
+  302231454903657294ULL, 483570327845851670ULL, 386856262276681336ULL,
+  309485009821345069ULL, 495176015714152110ULL, 396140812571321688ULL,
+  316912650057057351ULL, 507060240091291761ULL, 405648192073033409ULL,
+  324518553658426727ULL, 519229685853482763ULL, 415383748682786211ULL,
+  332306998946228969ULL, 531691198313966350ULL, 425352958651173080ULL,
+  340282366920938464ULL, 544451787073501542ULL, 435561429658801234ULL,
+  348449143727040987ULL, 557518629963265579ULL, 446014903970612463ULL,
+  356811923176489971ULL, 570899077082383953ULL, 456719261665907162ULL,
+  365375409332725730ULL
+};
+
+// 5^i normalized to 61 bits
+static const uint64_t _ryu_pow5_split[48] = {
+  1152921504606846976ULL, 1441151880758558720ULL, 1801439850948198400ULL,
+  2251799813685248000ULL, 1407374883553280000ULL, 1759218604441600000ULL,
+  2199023255552000000ULL, 1374389534720000000ULL, 1717986918400000000ULL,
+  2147483648000000000ULL, 1342177280000000000ULL, 1677721600000000000ULL,
+  2097152000000000000ULL, 1310720000000000000ULL, 1638400000000000000ULL,
+  2048000000000000000ULL, 1280000000000000000ULL, 1600000000000000000ULL,
+  2000000000000000000ULL, 1250000000000000000ULL, 1562500000000000000ULL,
+  1953125000000000000ULL, 1220703125000000000ULL, 1525878906250000000ULL,
+  1907348632812500000ULL, 1192092895507812500ULL, 1490116119384765625ULL,
+  1862645149230957031ULL, 1164153218269348144ULL, 1455191522836685180ULL,
+  1818989403545856475ULL, 2273736754432320594ULL, 1421085471520200371ULL,
+  1776356839400250464ULL, 2220446049250313080ULL, 1387778780781445675ULL,
+  1734723475976807094ULL, 2168404344971008868ULL, 1355252715606880542ULL,
+  1694065894508600678ULL, 2117582368135750847ULL, 1323488980084844279ULL,
+  1654361225106055349ULL, 2067951531382569187ULL, 1292469707114105741ULL,
+  1615587133892632177ULL, 2019483917365790221ULL, 1262177448353618888ULL
+};
+
+
+// ceil(log2(5^e)) for e > 0, 1 for e == 0
+static inline int32_t _ryu_pow5bits(const int32_t e)
+{
+  return (int32_t)(((uint32_t)e * 1217359U) >> 19U) + 1;
+}
+
+
+// floor(log10(2^e))
+static inline uint32_t _ryu_log10_pow2(const int32_t e)
+{
+  return ((uint32_t)e * 78913U) >> 18U;
+}
+
+
+// floor(log10(5^e))
+static inline uint32_t _ryu_log10_pow5(const int32_t e)
+{
+  return ((uint32_t)e * 732923U) >> 20U;
+}
+
+
+static inline bool _ryu_multiple_of_pow5(uint32_t value, const uint32_t p)
+{
+  uint32_t count = 0U;
+  while ((value % 5U) == 0U) {
+    value /= 5U;
+    ++count;
+  }
+  return count >= p;
+}
+
+
+// (m * factor) >> shift using two 32x32->64 multiplications, shift must be > 32
+static inline uint32_t _ryu_mul_shift(const uint32_t m, const uint64_t factor, const int32_t shift)
+{
+  const uint64_t bits0 = (uint64_t)m * (uint32_t)factor;
+  const uint64_t bits1 = (uint64_t)m * (uint32_t)(factor >> 32U);
+  return (uint32_t)(((bits0 >> 32U) + bits1) >> (shift - 32));
+}
+
+
+// convert the (positive) float into the shortest decimal mantissa * 10^exponent
+// that parses back to the same float
+static void _ryu_f2d(const float value, uint32_t* mantissa, int32_t* exponent)
+{
+  union {
+    uint32_t U;
+    float    F;
+  } conv;
+
+  conv.F = value;
+  const uint32_t ieee_mantissa = conv.U & ((1UL << RYU_FLOAT_MANTISSA_BITS) - 1U);
+  const uint32_t ieee_exponent = (conv.U >> RYU_FLOAT_MANTISSA_BITS) & 0xFFU;
+
+  if (!ieee_mantissa && !ieee_exponent) {
+    *mantissa = 0U;
+    *exponent = 0;
+    return;
+  }
+
+  // the value is m2 * 2^e2, with two extra bits for the interval bounds
+  int32_t e2;
+  uint32_t m2;
+  if (!ieee_exponent) {
+    e2 = 1 - RYU_FLOAT_BIAS - RYU_FLOAT_MANTISSA_BITS - 2;
+    m2 = ieee_mantissa;
+  }
+  else {
+    e2 = (int32_t)ieee_exponent - RYU_FLOAT_BIAS - RYU_FLOAT_MANTISSA_BITS - 2;
+    m2 = (1UL << RYU_FLOAT_MANTISSA_BITS) | ieee_mantissa;
+  }
+  const bool accept_bounds = !(m2 & 1U);
+
+  // interval of decimal values that round to the same float
+  const uint32_t mv = 4U * m2;
+  const uint32_t mp = 4U * m2 + 2U;
+  const uint32_t mm_shift = (ieee_mantissa != 0U) || (ieee_exponent <= 1U);
+  const uint32_t mm = 4U * m2 - 1U - mm_shift;
+
+  uint32_t vr, vp, vm;
+  int32_t e10;
+  bool vm_is_trailing_zeros = false;
+  bool vr_is_trailing_zeros = false;
+  uint8_t last_removed_digit = 0U;
+  if (e2 >= 0) {
+    const uint32_t q = _ryu_log10_pow2(e2);
+    e10 = (int32_t)q;
+    const int32_t k = RYU_POW5_INV_BITCOUNT + _ryu_pow5bits((int32_t)q) - 1;
+    const int32_t i = -e2 + (int32_t)q + k;
+    vr = _ryu_mul_shift(mv, _ryu_pow5_inv_split[q], i);
+    vp = _ryu_mul_shift(mp, _ryu_pow5_inv_split[q], i);
+    vm = _ryu_mul_shift(mm, _ryu_pow5_inv_split[q], i);
+    if ((q != 0U) && ((vp - 1U) / 10U <= vm / 10U)) {
+      // we need to know one removed digit even if we are not going to loop below
+      const int32_t l = RYU_POW5_INV_BITCOUNT + _ryu_pow5bits((int32_t)q - 1) - 1;
+      last_removed_digit = (uint8_t)(_ryu_mul_shift(mv, _ryu_pow5_inv_split[q - 1U], -e2 + (int32_t)q - 1 + l) % 10U);
+    }
+    if (q <= 9U) {
+      // only one of mp, mv, and mm can be a multiple of 5, if any
+      if ((mv % 5U) == 0U) {
+        vr_is_trailing_zeros = _ryu_multiple_of_pow5(mv, q);
+      }
+      else if (accept_bounds) {
+        vm_is_trailing_zeros = _ryu_multiple_of_pow5(mm, q);
+      }
+      else {
+        vp -= _ryu_multiple_of_pow5(mp, q);
+      }
+    }
+  }
+  else {
+    const uint32_t q = _ryu_log10_pow5(-e2);
+    e10 = (int32_t)q + e2;
+    const int32_t i = -e2 - (int32_t)q;
+    const int32_t k = _ryu_pow5bits(i) - RYU_POW5_BITCOUNT;
+    int32_t j = (int32_t)q - k;
+    vr = _ryu_mul_shift(mv, _ryu_pow5_split[i], j);
+    vp = _ryu_mul_shift(mp, _ryu_pow5_split[i], j);
+    vm = _ryu_mul_shift(mm, _ryu_pow5_split[i], j);
+    if ((q != 0U) && ((vp - 1U) / 10U <= vm / 10U)) {
+      j = (int32_t)q - 1 - (_ryu_pow5bits(i + 1) - RYU_POW5_BITCOUNT);
+      last_removed_digit = (uint8_t)(_ryu_mul_shift(mv, _ryu_pow5_split[i + 1], j) % 10U);
+    }
+    if (q <= 1U) {
+      // mv = 4 * m2 always has at least two trailing 0 bits
+      vr_is_trailing_zeros = true;
+      if (accept_bounds) {
+        // mm = mv - 1 - mm_shift has one trailing 0 bit iff mm_shift == 1
+        vm_is_trailing_zeros = (mm_shift == 1U);
+      }
+      else {
+        // mp = mv + 2 always has at least one trailing 0 bit
+        --vp;
+      }
+    }
+    else if (q < 31U) {
+      vr_is_trailing_zeros = !(mv & ((1UL << (q - 1U)) - 1U));
+    }
+  }
+
+  // find the shortest decimal representation in the interval
+  int32_t removed = 0;
+  uint32_t output;
+  if (vm_is_trailing_zeros || vr_is_trailing_zeros) {
+    // general case, rare
+    while (vp / 10U > vm / 10U) {
+      vm_is_trailing_zeros &= (vm % 10U) == 0U;
+      vr_is_trailing_zeros &= last_removed_digit == 0U;
+      last_removed_digit = (uint8_t)(vr % 10U);
+      vr /= 10U;
+      vp /= 10U;
+      vm /= 10U;
+      ++removed;
+    }
+    if (vm_is_trailing_zeros) {
+      while ((vm % 10U) == 0U) {
+        vr_is_trailing_zeros &= last_removed_digit == 0U;
+        last_removed_digit = (uint8_t)(vr % 10U);
+        vr /= 10U;
+        vp /= 10U;
+        vm /= 10U;
+        ++removed;
+      }
+    }
+    if (vr_is_trailing_zeros && (last_removed_digit == 5U) && !(vr & 1U)) {
+      // round even if the exact number is .....50..0
+      last_removed_digit = 4U;
+    }
+    // take vr + 1 if vr is outside the bounds or we need to round up
+    output = vr + (((vr == vm) && (!accept_bounds || !vm_is_trailing_zeros)) || (last_removed_digit >= 5U));
+  }
+  else {
+    // common case
+    while (vp / 10U > vm / 10U) {
+      last_removed_digit = (uint8_t)(vr % 10U);
+      vr /= 10U;
+      vp /= 10U;
+      vm /= 10U;
+      ++removed;
+    }
+    output = vr + ((vr == vm) || (last_removed_digit >= 5U));
+  }
+
+  // strip trailing zeros, they are not significant
+  while (output && !(output % 10U)) {
+    output /= 10U;
+    ++removed;
+  }
+
+  *mantissa = output;
+  *exponent = e10 + removed;
+}
+
+
+// internal shortest round-trip format for "%g" without precision
+// like "%g" the fixed notation is used for exponents in [-4, PRINTF_DEFAULT_FLOAT_PRECISION)
+static size_t _stoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, float value, unsigned int width, unsigned int flags)
+{
+  char buf[PRINTF_FTOA_BUFFER_SIZE];
+  size_t len = 0U;
+
+  // test for negative
+  const bool negative = value < 0;
+  if (negative) {
+    value = 0 - value;
+  }
+
+  uint32_t mantissa;
+  int32_t exponent;
+  _ryu_f2d(value, &mantissa, &exponent);
+
+  // number of significant digits and the scientific exponent
+  int32_t digits = 1;
+  for (uint32_t m = mantissa; m >= 10U; m /= 10U) {
+    digits++;
+  }
+  const int32_t expval = exponent + digits - 1;
+
+  // the string is built reversed
+  if ((expval < -4) || (expval >= (int32_t)PRINTF_DEFAULT_FLOAT_PRECISION)) {
+    // exponential notation, at least two exponent digits
+    uint32_t e = (uint32_t)((expval < 0) ? -expval : expval);
+    do {
+      buf[len++] = (char)('0' + (e % 10U));
+      e /= 10U;
+    } while (e);
+    if (len < 2U) {
+      buf[len++] = '0';
+    }
+    buf[len++] = (expval < 0) ? '-' : '+';
+    buf[len++] = (flags & FLAGS_UPPERCASE) ? 'E' : 'e';
+    for (int32_t i = 1; i < digits; i++) {
+      buf[len++] = (char)('0' + (mantissa % 10U));
+      mantissa /= 10U;
+    }
+    if (digits > 1) {
+      buf[len++] = '.';
+    }
+    buf[len++] = (char)('0' + mantissa);
+  }
+  else if (exponent >= 0) {
+    // integer, pad the trailing zeros
+    for (int32_t i = 0; i < exponent; i++) {
+      buf[len++] = '0';
+    }
+    do {
+      buf[len++] = (char)('0' + (mantissa % 10U));
+      mantissa /= 10U;
+    } while (mantissa);
+  }
+  else if (expval >= 0) {
+    // decimal point inside the digits
+    for (int32_t i = 0; i < -exponent; i++) {
+      buf[len++] = (char)('0' + (mantissa % 10U));
+      mantissa /= 10U;
+    }
+    buf[len++] = '.';
+    do {
+      buf[len++] = (char)('0' + (mantissa % 10U));
+      mantissa /= 10U;
+    } while (mantissa);
+  }
+  else {
+    // leading zeros after the decimal point
+    for (int32_t i = 0; i < digits; i++) {
+      buf[len++] = (char)('0' + (mantissa % 10U));
+      mantissa /= 10U;
+    }
+    for (int32_t i = 1; i < -expval; i++) {
+      buf[len++] = '0';
+    }
+    buf[len++] = '.';
+    buf[len++] = '0';
+  }
+
+  // pad leading zeros
+  if (!(flags & FLAGS_LEFT) && (flags & FLAGS_ZEROPAD)) {
+    if (width && (negative || (flags & (FLAGS_PLUS | FLAGS_SPACE)))) {
+      width--;
+    }
+    while ((len < width) && (len < PRINTF_FTOA_BUFFER_SIZE)) {
+      buf[len++] = '0';
+    }
+  }
+
+  if (len < PRINTF_FTOA_BUFFER_SIZE) {
+    if (negative) {
+      buf[len++] = '-';
+    }
+    else if (flags & FLAGS_PLUS) {
+      buf[len++] = '+';  // ignore the space if the '+' exists
+    }
+    else if (flags & FLAGS_SPACE) {
+      buf[len++] = ' ';
+    }
+  }
+
+  return _out_rev(out, buffer, idx, maxlen, buf, len, width, flags);
+}
+#endif  // PRINTF_SUPPORT_SHORTEST_ROUNDTRIP
+
+
 // internal ftoa variant for exponential floating-point type, contributed by Martijn Jasperse <m.jasperse@gmail.com>
-static size_t _etoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags)
+static size_t _etoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, floating_type value, unsigned int prec, unsigned int width, unsigned int flags)
 {
   // check for NaN and special values
-  if ((value != value) || (value > DBL_MAX) || (value < -DBL_MAX)) {
+  if ((value != value) || (value > FLOATING_MAX) || (value < -FLOATING_MAX)) {
     return _ftoa(out, buffer, idx, maxlen, value, prec, width, flags);
   }
 
+#if defined(PRINTF_SUPPORT_SHORTEST_ROUNDTRIP)
+  if ((flags & FLAGS_ADAPT_EXP) && !(flags & FLAGS_PRECISION)) {
+    return _stoa(out, buffer, idx, maxlen, value, width, flags);
+  }
+#endif
+
   // determine the sign
   const bool negative = value < 0;
   if (negative) {
@@ -482,6 +888,43 @@ static size_t _etoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, d
     prec = PRINTF_DEFAULT_FLOAT_PRECISION;
   }
 
+#if defined(PRINTF_SUPPORT_SINGLE_PRECISION)
+  // determine the decimal exponent, see the double variant below
+  union {
+    uint32_t U;
+    float    F;
+  } conv;
+
+  // scale denormals into the normal range so the log approximation holds
+  int expadj = 0;
+  if ((value < FLT_MIN) && (value > 0)) {
+    value *= 1e10f;
+    expadj = -10;
+  }
+
+  conv.F = value;
+  int exp2 = (int)((conv.U >> 23U) & 0x0FFU) - 127;             // effectively log2
+  conv.U = (conv.U & ((1UL << 23U) - 1U)) | (127UL << 23U);     // drop the exponent so conv.F is now in [1,2)
+  int expval = (int)(0.1760912590558f + (float)exp2 * 0.301029995663981f + (conv.F - 1.5f) * 0.289529654602168f);
+  if (!(value > 0)) {
+    expval = 0;
+  }
+  // the float exponent range is small enough to look up 10^expval exactly rounded,
+  // the continued fraction below loses too much precision in float arithmetic
+  if (expval > POW10F_MAX_EXP) {
+    expval = POW10F_MAX_EXP;
+  }
+  else if (expval < POW10F_MIN_EXP) {
+    expval = POW10F_MIN_EXP;
+  }
+  float scale = _pow10f[expval - POW10F_MIN_EXP];
+  // correct for rounding errors
+  while ((value > 0) && (value < scale) && (expval > POW10F_MIN_EXP)) {
+    expval--;
+    scale = _pow10f[expval - POW10F_MIN_EXP];
+  }
+  expval += expadj;
+#else
   // determine the decimal exponent
   // based on the algorithm by David Gay (https://www.ampl.com/netlib/fp/dtoa.c)
   union {
@@ -506,6 +949,8 @@ static size_t _etoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, d
     expval--;
     conv.F /= 10;
   }
+  const double scale = conv.F;
+#endif
 
   // the exponent format is "%+03d" and largest value is "307", so set aside 4-5 characters
   unsigned int minwidth = ((expval < 100) && (expval > -100)) ? 4U : 5U;
@@ -513,7 +958,7 @@ static size_t _etoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, d
   // in "%g" mode, "prec" is the number of *significant figures* not decimals
   if (flags & FLAGS_ADAPT_EXP) {
     // do we want to fall-back to "%f" mode?
-    if ((value >= 1e-4) && (value < 1e6)) {
+    if ((value >= FLOATING_C(1e-4)) && (value < FLOATING_C(1e6))) {
       if ((int)prec > expval) {
         prec = (unsigned)((int)prec - expval - 1);
       }
@@ -549,7 +994,7 @@ static size_t _etoa(out_fct_type out, char* buffer, size_t idx, size_t maxlen, d
 
   // rescale the float value
   if (expval) {
-    value /= conv.F;
+    value /= scale;
   }
 
   // output the floating part
@@ -758,7 +1203,7 @@ static int _vsnprintf(out_fct_type out, char* buffer, const size_t maxlen, const
       case 'f' :
       case 'F' :
         if (*format == 'F') flags |= FLAGS_UPPERCASE;
-        idx = _ftoa(out, buffer, idx, maxlen, va_arg(va, double), precision, width, flags);
+        idx = _ftoa(out, buffer, idx, maxlen, (floating_type)va_arg(va, double), precision, width, flags);
         format++;
         break;
 #if defined(PRINTF_SUPPORT_EXPONENTIAL)
@@ -768,7 +1213,7 @@ static int _vsnprintf(out_fct_type out, char* buffer, const size_t maxlen, const
       case 'G':
         if ((*format == 'g')||(*format == 'G')) flags |= FLAGS_ADAPT_EXP;
         if ((*format == 'E')||(*format == 'G')) flags |= FLAGS_UPPERCASE;
-        idx = _etoa(out, buffer, idx, maxlen, va_arg(va, double), precision, width, flags);
+        idx = _etoa(out, buffer, idx, maxlen, (floating_type)va_arg(va, double), precision, width, flags);
         format++;
         break;
 #endif  // PRINTF_SUPPORT_EXPONENTIAL
@@ -857,6 +1302,38 @@ static int _vsnprintf(out_fct_type out, char* buffer, const size_t maxlen, const
 }
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+size_t printf_ntoa_long_(out_fct_type out, char* buffer, size_t idx, size_t maxlen, unsigned long value, int negative, unsigned long base, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  return _ntoa_long(out, buffer, idx, maxlen, value, negative != 0, base, prec, width, flags);
+}
+
+
+#if defined(PRINTF_SUPPORT_LONG_LONG)
+size_t printf_ntoa_long_long_(out_fct_type out, char* buffer, size_t idx, size_t maxlen, unsigned long long value, int negative, unsigned long long base, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  return _ntoa_long_long(out, buffer, idx, maxlen, value, negative != 0, base, prec, width, flags);
+}
+#endif
+
+
+#if defined(PRINTF_SUPPORT_FLOAT)
+size_t printf_ftoa_(out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  return _ftoa(out, buffer, idx, maxlen, (floating_type)value, prec, width, flags);
+}
+
+
+#if defined(PRINTF_SUPPORT_EXPONENTIAL)
+size_t printf_etoa_(out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags)
+{
+  return _etoa(out, buffer, idx, maxlen, (floating_type)value, prec, width, flags);
+}
+#endif
+#endif
+
+
 ///////////////////////////////////////////////////////////////////////////////
 
 int printf_(const char* format, ...)
@@ -109,6 +109,36 @@ int vprintf_(const char* format, va_list va);
 int fctprintf(void (*out)(char character, void* arg), void* arg, const char* format, ...);
 
 
+/**
+ * Conversion flags and primitives of the format parser, exported for the compile-time
+ * parsed C++ front end (printf.hpp). Each primitive appends a single conversion to the
+ * output and returns the index after the last written character.
+ * \param out Output function, called for every character with the buffer, index and maxlen
+ * \param buffer Argument passed to the output function, e.g. the destination buffer
+ * \param idx Index of the first character to write
+ * \param maxlen Size of the buffer, passed to the output function
+ */
+#define PRINTF_FLAGS_ZEROPAD   (1U <<  0U)
+#define PRINTF_FLAGS_LEFT      (1U <<  1U)
+#define PRINTF_FLAGS_PLUS      (1U <<  2U)
+#define PRINTF_FLAGS_SPACE     (1U <<  3U)
+#define PRINTF_FLAGS_HASH      (1U <<  4U)
+#define PRINTF_FLAGS_UPPERCASE (1U <<  5U)
+#define PRINTF_FLAGS_CHAR      (1U <<  6U)
+#define PRINTF_FLAGS_SHORT     (1U <<  7U)
+#define PRINTF_FLAGS_LONG      (1U <<  8U)
+#define PRINTF_FLAGS_LONG_LONG (1U <<  9U)
+#define PRINTF_FLAGS_PRECISION (1U << 10U)
+#define PRINTF_FLAGS_ADAPT_EXP (1U << 11U)
+
+typedef void (*printf_out_fct_type)(char character, void* buffer, size_t idx, size_t maxlen);
+
+size_t printf_ntoa_long_(printf_out_fct_type out, char* buffer, size_t idx, size_t maxlen, unsigned long value, int negative, unsigned long base, unsigned int prec, unsigned int width, unsigned int flags);
+size_t printf_ntoa_long_long_(printf_out_fct_type out, char* buffer, size_t idx, size_t maxlen, unsigned long long value, int negative, unsigned long long base, unsigned int prec, unsigned int width, unsigned int flags);
+size_t printf_ftoa_(printf_out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags);
+size_t printf_etoa_(printf_out_fct_type out, char* buffer, size_t idx, size_t maxlen, double value, unsigned int prec, unsigned int width, unsigned int flags);
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,569 @@
+///////////////////////////////////////////////////////////////////////////////
+// \license The MIT License (MIT)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// \brief Compile-time parsed front end for the tiny printf (C++17).
+//        The format string is parsed while compiling: flags, width, precision
+//        and length are resolved to constants and the argument types are
+//        checked against them. Every call lowers to a fixed sequence of
+//        literal writes and calls of the printf_ntoa_*/printf_ftoa_/printf_etoa_
+//        primitives, so there is no runtime parse and the linker can drop the
+//        conversions that are never used (e.g. float or long long).
+//
+//        Usage:
+//          printf_ct::printf_(PRINTF_FMT("Hour: %02u, Min: %02u\n"), hour, min);
+//          printf_ct::snprintf_(buffer, sizeof(buffer), PRINTF_FMT("%-8s|%+.3f"), name, value);
+//
+//        Supported: the flags "0-+ #", width and precision (literal or '*'),
+//        the lengths hh, h, l, ll, j, z, t and the specifiers d i u x X o b f F
+//        e E g G c s p %. Anything else is rejected at compile time.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _PRINTF_HPP_
+#define _PRINTF_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#include "printf.h"
+
+
+/**
+ * Wrap a string literal so it can be passed as a compile-time format
+ * \param str The format string literal
+ */
+#define PRINTF_FMT(str) \
+  ([] { struct printf_format { static constexpr const char* c_str() { return str; } }; return printf_format{}; }())
+
+
+namespace printf_ct {
+
+namespace detail {
+
+// length modifiers
+enum length_type : char {
+  LENGTH_NONE, LENGTH_CHAR, LENGTH_SHORT, LENGTH_LONG, LENGTH_LONG_LONG,
+  LENGTH_INTMAX, LENGTH_SIZE, LENGTH_PTRDIFF
+};
+
+// one parsed conversion and the literal text in front of it
+struct spec_type {
+  std::size_t   lit_begin     = 0U;
+  std::size_t   lit_len       = 0U;
+  char          specifier     = '\0';   // '\0' for the trailing literal
+  length_type   length        = LENGTH_NONE;
+  unsigned int  flags         = 0U;
+  unsigned int  width         = 0U;
+  unsigned int  precision     = 0U;
+  bool          width_arg     = false;  // width is passed as '*' argument
+  bool          precision_arg = false;  // precision is passed as '*' argument
+  bool          valid         = true;
+  std::size_t   arg           = 0U;     // index of the first argument of this conversion
+};
+
+
+constexpr bool is_digit(char ch)
+{
+  return (ch >= '0') && (ch <= '9');
+}
+
+
+constexpr bool is_integer_specifier(char ch)
+{
+  return (ch == 'd') || (ch == 'i') || (ch == 'u') || (ch == 'x') || (ch == 'X') || (ch == 'o') || (ch == 'b');
+}
+
+
+// number of conversions in the format, plus one for the trailing literal
+template <class Fmt>
+constexpr std::size_t spec_count()
+{
+  const char* format = Fmt::c_str();
+  std::size_t count = 1U;
+  for (std::size_t i = 0U; format[i]; i++) {
+    if (format[i] == '%') {
+      count++;
+      // skip to the specifier, a "%%" counts as one conversion
+      i++;
+      while (format[i] && ((format[i] == '0') || (format[i] == '-') || (format[i] == '+') || (format[i] == ' ') || (format[i] == '#') ||
+                           (format[i] == '.') || (format[i] == '*') || is_digit(format[i]) ||
+                           (format[i] == 'l') || (format[i] == 'h') || (format[i] == 't') || (format[i] == 'j') || (format[i] == 'z'))) {
+        i++;
+      }
+      if (!format[i]) {
+        break;
+      }
+    }
+  }
+  return count;
+}
+
+
+// the same state machine as _vsnprintf, evaluated by the compiler
+template <class Fmt>
+constexpr std::array<spec_type, spec_count<Fmt>()> parse()
+{
+  std::array<spec_type, spec_count<Fmt>()> specs{};
+  const char* format = Fmt::c_str();
+  std::size_t pos = 0U;
+  std::size_t arg = 0U;
+
+  for (std::size_t n = 0U; n < specs.size(); n++) {
+    spec_type& spec = specs[n];
+
+    // literal text
+    spec.lit_begin = pos;
+    while (format[pos] && (format[pos] != '%')) {
+      pos++;
+    }
+    spec.lit_len = pos - spec.lit_begin;
+    if (!format[pos]) {
+      break;
+    }
+    pos++;
+
+    // evaluate flags
+    for (bool more = true; more; ) {
+      switch (format[pos]) {
+        case '0': spec.flags |= PRINTF_FLAGS_ZEROPAD; pos++; break;
+        case '-': spec.flags |= PRINTF_FLAGS_LEFT;    pos++; break;
+        case '+': spec.flags |= PRINTF_FLAGS_PLUS;    pos++; break;
+        case ' ': spec.flags |= PRINTF_FLAGS_SPACE;   pos++; break;
+        case '#': spec.flags |= PRINTF_FLAGS_HASH;    pos++; break;
+        default : more = false;                               break;
+      }
+    }
+
+    // evaluate width field
+    if (is_digit(format[pos])) {
+      while (is_digit(format[pos])) {
+        spec.width = spec.width * 10U + (unsigned int)(format[pos++] - '0');
+      }
+    }
+    else if (format[pos] == '*') {
+      spec.width_arg = true;
+      pos++;
+    }
+
+    // evaluate precision field
+    if (format[pos] == '.') {
+      spec.flags |= PRINTF_FLAGS_PRECISION;
+      pos++;
+      if (is_digit(format[pos])) {
+        while (is_digit(format[pos])) {
+          spec.precision = spec.precision * 10U + (unsigned int)(format[pos++] - '0');
+        }
+      }
+      else if (format[pos] == '*') {
+        spec.precision_arg = true;
+        pos++;
+      }
+    }
+
+    // evaluate length field
+    switch (format[pos]) {
+      case 'l' :
+        spec.length = LENGTH_LONG;
+        pos++;
+        if (format[pos] == 'l') {
+          spec.length = LENGTH_LONG_LONG;
+          pos++;
+        }
+        break;
+      case 'h' :
+        spec.length = LENGTH_SHORT;
+        pos++;
+        if (format[pos] == 'h') {
+          spec.length = LENGTH_CHAR;
+          pos++;
+        }
+        break;
+      case 't' : spec.length = LENGTH_PTRDIFF; pos++; break;
+      case 'j' : spec.length = LENGTH_INTMAX;  pos++; break;
+      case 'z' : spec.length = LENGTH_SIZE;    pos++; break;
+      default  : break;
+    }
+
+    // evaluate specifier
+    spec.specifier = format[pos];
+    switch (spec.specifier) {
+      case 'd' :
+      case 'i' :
+        spec.flags &= ~PRINTF_FLAGS_HASH;   // no hash for dec format
+        break;
+      case 'X' :
+        spec.flags |= PRINTF_FLAGS_UPPERCASE;
+        // fall through
+      case 'u' :
+      case 'x' :
+      case 'o' :
+      case 'b' :
+        // no plus or space flag for u, x, X, o, b
+        spec.flags &= ~(PRINTF_FLAGS_PLUS | PRINTF_FLAGS_SPACE);
+        if (spec.specifier == 'u') {
+          spec.flags &= ~PRINTF_FLAGS_HASH;
+        }
+        break;
+      case 'F' :
+      case 'E' :
+        spec.flags |= PRINTF_FLAGS_UPPERCASE;
+        break;
+      case 'G' :
+        spec.flags |= PRINTF_FLAGS_UPPERCASE;
+        // fall through
+      case 'g' :
+        spec.flags |= PRINTF_FLAGS_ADAPT_EXP;
+        break;
+      case 'p' :
+        spec.width = sizeof(void*) * 2U;
+        spec.flags |= PRINTF_FLAGS_ZEROPAD | PRINTF_FLAGS_UPPERCASE;
+        break;
+      case 'f' :
+      case 'e' :
+      case 'c' :
+      case 's' :
+      case '%' :
+        break;
+      default :
+        // unknown specifier or '%' at the end of the format
+        spec.valid = false;
+        break;
+    }
+    // ignore '0' flag when precision is given
+    if ((spec.flags & PRINTF_FLAGS_PRECISION) && is_integer_specifier(spec.specifier)) {
+      spec.flags &= ~PRINTF_FLAGS_ZEROPAD;
+    }
+    if (spec.specifier) {
+      pos++;
+    }
+
+    // assign the arguments
+    spec.arg = arg;
+    arg += spec.width_arg ? 1U : 0U;
+    arg += spec.precision_arg ? 1U : 0U;
+    arg += (spec.specifier != '%') ? 1U : 0U;
+  }
+
+  return specs;
+}
+
+
+// number of arguments consumed by the format
+template <class Fmt>
+constexpr std::size_t arg_count()
+{
+  constexpr auto specs = parse<Fmt>();
+  std::size_t count = 0U;
+  for (std::size_t n = 0U; n + 1U < specs.size(); n++) {
+    count += specs[n].width_arg ? 1U : 0U;
+    count += specs[n].precision_arg ? 1U : 0U;
+    count += (specs[n].specifier != '%') ? 1U : 0U;
+  }
+  return count;
+}
+
+
+template <class Fmt>
+inline constexpr auto specs = parse<Fmt>();
+
+
+template <length_type Length>
+struct signed_length;
+template <> struct signed_length<LENGTH_NONE>      { typedef int            type; };
+template <> struct signed_length<LENGTH_CHAR>      { typedef signed char    type; };
+template <> struct signed_length<LENGTH_SHORT>     { typedef short int      type; };
+template <> struct signed_length<LENGTH_LONG>      { typedef long           type; };
+template <> struct signed_length<LENGTH_LONG_LONG> { typedef long long      type; };
+template <> struct signed_length<LENGTH_INTMAX>    { typedef std::intmax_t  type; };
+template <> struct signed_length<LENGTH_SIZE>      { typedef std::make_signed_t<std::size_t> type; };
+template <> struct signed_length<LENGTH_PTRDIFF>   { typedef std::ptrdiff_t type; };
+
+
+template <class T>
+inline constexpr bool dependent_false = false;
+
+
+// internal buffer output
+inline void out_buffer(char character, void* buffer, std::size_t idx, std::size_t maxlen)
+{
+  if (idx < maxlen) {
+    static_cast<char*>(buffer)[idx] = character;
+  }
+}
+
+
+// internal _putchar wrapper
+inline void out_char(char character, void* buffer, std::size_t idx, std::size_t maxlen)
+{
+  (void)buffer; (void)idx; (void)maxlen;
+  if (character) {
+    _putchar(character);
+  }
+}
+
+
+// wrapper (used as buffer) for output function type
+struct out_fct_wrap_type {
+  void  (*fct)(char character, void* arg);
+  void* arg;
+};
+
+
+// internal output function wrapper
+inline void out_fct(char character, void* buffer, std::size_t idx, std::size_t maxlen)
+{
+  (void)idx; (void)maxlen;
+  if (character) {
+    static_cast<out_fct_wrap_type*>(buffer)->fct(character, static_cast<out_fct_wrap_type*>(buffer)->arg);
+  }
+}
+
+
+// integer conversion, the value is truncated to the length modifier type like va_arg would
+template <char Specifier, length_type Length, class T>
+inline std::size_t format_integer(printf_out_fct_type out, char* buffer, std::size_t idx, std::size_t maxlen, const T& arg, unsigned int width, unsigned int precision, unsigned int flags)
+{
+  typedef typename signed_length<Length>::type signed_type;
+  typedef std::make_unsigned_t<signed_type> unsigned_type;
+  static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "integer conversion requires an integral argument");
+  // like variadic arguments, hh and h accept anything promoted to int
+  static_assert(sizeof(T) <= ((sizeof(signed_type) > sizeof(int)) ? sizeof(signed_type) : sizeof(int)), "argument is wider than the length modifier of the conversion");
+
+  constexpr unsigned int base = ((Specifier == 'x') || (Specifier == 'X')) ? 16U : (Specifier == 'o') ? 8U : (Specifier == 'b') ? 2U : 10U;
+  constexpr bool is_long_long = sizeof(signed_type) > sizeof(long);
+
+  if constexpr ((Specifier == 'd') || (Specifier == 'i')) {
+    const signed_type value = static_cast<signed_type>(arg);
+    const unsigned_type abs_value = (value > 0) ? static_cast<unsigned_type>(value) : static_cast<unsigned_type>(0U - static_cast<unsigned_type>(value));
+    if constexpr (is_long_long) {
+      return printf_ntoa_long_long_(out, buffer, idx, maxlen, abs_value, value < 0, base, precision, width, flags);
+    }
+    else {
+      return printf_ntoa_long_(out, buffer, idx, maxlen, abs_value, value < 0, base, precision, width, flags);
+    }
+  }
+  else {
+    const unsigned_type value = static_cast<unsigned_type>(arg);
+    if constexpr (is_long_long) {
+      return printf_ntoa_long_long_(out, buffer, idx, maxlen, value, false, base, precision, width, flags);
+    }
+    else {
+      return printf_ntoa_long_(out, buffer, idx, maxlen, value, false, base, precision, width, flags);
+    }
+  }
+}
+
+
+// lower one conversion and recurse into the next one
+template <class Fmt, std::size_t N, class Tuple>
+inline std::size_t format(printf_out_fct_type out, char* buffer, std::size_t idx, std::size_t maxlen, const Tuple& args)
+{
+  constexpr spec_type spec = specs<Fmt>[N];
+  static_assert(spec.valid, "unknown conversion specifier in format string");
+
+  // literal text in front of the conversion
+  const char* literal = Fmt::c_str() + spec.lit_begin;
+  for (std::size_t i = 0U; i < spec.lit_len; i++) {
+    out(literal[i], buffer, idx++, maxlen);
+  }
+
+  if constexpr (spec.specifier == '\0') {
+    (void)args;
+    return idx;
+  }
+  else {
+    unsigned int width = spec.width;
+    unsigned int precision = spec.precision;
+    unsigned int flags = spec.flags;
+    constexpr std::size_t value_arg = spec.arg + (spec.width_arg ? 1U : 0U) + (spec.precision_arg ? 1U : 0U);
+
+    if constexpr (spec.width_arg) {
+      static_assert(std::is_same_v<std::decay_t<std::tuple_element_t<spec.arg, Tuple>>, int>, "'*' width requires an int argument");
+      const int w = std::get<spec.arg>(args);
+      if (w < 0) {
+        flags |= PRINTF_FLAGS_LEFT;    // reverse padding
+        width = (unsigned int)-w;
+      }
+      else {
+        width = (unsigned int)w;
+      }
+    }
+    if constexpr (spec.precision_arg) {
+      constexpr std::size_t precision_idx = spec.arg + (spec.width_arg ? 1U : 0U);
+      static_assert(std::is_same_v<std::decay_t<std::tuple_element_t<precision_idx, Tuple>>, int>, "'*' precision requires an int argument");
+      const int prec = std::get<precision_idx>(args);
+      precision = prec > 0 ? (unsigned int)prec : 0U;
+    }
+
+    if constexpr (spec.specifier == '%') {
+      out('%', buffer, idx++, maxlen);
+    }
+    else {
+      typedef std::decay_t<std::tuple_element_t<value_arg, Tuple>> arg_type;
+      const arg_type& value = std::get<value_arg>(args);
+
+      if constexpr (is_integer_specifier(spec.specifier)) {
+        idx = format_integer<spec.specifier, spec.length>(out, buffer, idx, maxlen, value, width, precision, flags);
+      }
+      else if constexpr ((spec.specifier == 'f') || (spec.specifier == 'F')) {
+#if defined(PRINTF_DISABLE_SUPPORT_FLOAT)
+        static_assert(dependent_false<arg_type>, "float support is disabled");
+#endif
+        static_assert(std::is_floating_point_v<arg_type>, "%f requires a floating point argument");
+        idx = printf_ftoa_(out, buffer, idx, maxlen, static_cast<double>(value), precision, width, flags);
+      }
+      else if constexpr ((spec.specifier == 'e') || (spec.specifier == 'E') || (spec.specifier == 'g') || (spec.specifier == 'G')) {
+#if defined(PRINTF_DISABLE_SUPPORT_FLOAT) || defined(PRINTF_DISABLE_SUPPORT_EXPONENTIAL)
+        static_assert(dependent_false<arg_type>, "exponential float support is disabled");
+#endif
+        static_assert(std::is_floating_point_v<arg_type>, "%e/%g requires a floating point argument");
+        idx = printf_etoa_(out, buffer, idx, maxlen, static_cast<double>(value), precision, width, flags);
+      }
+      else if constexpr (spec.specifier == 'c') {
+        static_assert(std::is_integral_v<arg_type>, "%c requires a character argument");
+        unsigned int l = 1U;
+        // pre padding
+        if (!(flags & PRINTF_FLAGS_LEFT)) {
+          while (l++ < width) {
+            out(' ', buffer, idx++, maxlen);
+          }
+        }
+        // char output
+        out(static_cast<char>(value), buffer, idx++, maxlen);
+        // post padding
+        if (flags & PRINTF_FLAGS_LEFT) {
+          while (l++ < width) {
+            out(' ', buffer, idx++, maxlen);
+          }
+        }
+      }
+      else if constexpr (spec.specifier == 's') {
+        static_assert(std::is_convertible_v<arg_type, const char*>, "%s requires a string argument");
+        const char* p = value;
+        // internal secure strlen, limited by the precision
+        unsigned int l = 0U;
+        for (const char* s = p; *s && (!precision || (l < precision)); ++s) {
+          l++;
+        }
+        if (flags & PRINTF_FLAGS_PRECISION) {
+          l = (l < precision ? l : precision);
+        }
+        // pre padding
+        if (!(flags & PRINTF_FLAGS_LEFT)) {
+          while (l++ < width) {
+            out(' ', buffer, idx++, maxlen);
+          }
+        }
+        // string output
+        while ((*p != 0) && (!(flags & PRINTF_FLAGS_PRECISION) || precision--)) {
+          out(*(p++), buffer, idx++, maxlen);
+        }
+        // post padding
+        if (flags & PRINTF_FLAGS_LEFT) {
+          while (l++ < width) {
+            out(' ', buffer, idx++, maxlen);
+          }
+        }
+      }
+      else if constexpr (spec.specifier == 'p') {
+        static_assert(std::is_pointer_v<arg_type> || std::is_null_pointer_v<arg_type>, "%p requires a pointer argument");
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(static_cast<const volatile void*>(value));
+        if constexpr (sizeof(std::uintptr_t) > sizeof(unsigned long)) {
+          idx = printf_ntoa_long_long_(out, buffer, idx, maxlen, address, false, 16U, precision, width, flags);
+        }
+        else {
+          idx = printf_ntoa_long_(out, buffer, idx, maxlen, address, false, 16U, precision, width, flags);
+        }
+      }
+    }
+
+    return format<Fmt, N + 1U>(out, buffer, idx, maxlen, args);
+  }
+}
+
+
+template <class Fmt, class... Args>
+inline int vformat(printf_out_fct_type out, char* buffer, std::size_t maxlen, const Args&... args)
+{
+  static_assert(arg_count<Fmt>() == sizeof...(Args), "number of arguments does not match the format string");
+  const std::size_t idx = format<Fmt, 0U>(out, buffer, 0U, maxlen, std::forward_as_tuple(args...));
+  // termination
+  out(static_cast<char>(0), buffer, idx < maxlen ? idx : maxlen - 1U, maxlen);
+  // return written chars without terminating \0
+  return static_cast<int>(idx);
+}
+
+} // namespace detail
+
+
+/**
+ * Compile-time parsed printf, see printf_()
+ * You have to implement _putchar if you use printf_ct::printf_()
+ * \param format A format created with PRINTF_FMT("...")
+ * \return The number of characters that are written, not counting the terminating null character
+ */
+template <class Fmt, class... Args>
+inline int printf_(Fmt format, const Args&... args)
+{
+  (void)format;
+  char buffer[1];
+  return detail::vformat<Fmt>(detail::out_char, buffer, (std::size_t)-1, args...);
+}
+
+
+/**
+ * Compile-time parsed snprintf, see snprintf_()
+ * \param buffer A pointer to the buffer where to store the formatted string
+ * \param count The maximum number of characters to store in the buffer, including a terminating null character
+ * \param format A format created with PRINTF_FMT("...")
+ * \return The number of characters that COULD have been written into the buffer, not counting the terminating
+ *         null character
+ */
+template <class Fmt, class... Args>
+inline int snprintf_(char* buffer, std::size_t count, Fmt format, const Args&... args)
+{
+  (void)format;
+  return detail::vformat<Fmt>(detail::out_buffer, buffer, count, args...);
+}
+
+
+/**
+ * Compile-time parsed fctprintf, see fctprintf()
+ * \param out An output function which takes one character and an argument pointer
+ * \param arg An argument pointer for user data passed to output function
+ * \param format A format created with PRINTF_FMT("...")
+ * \return The number of characters that are sent to the output function, not counting the terminating null character
+ */
+template <class Fmt, class... Args>
+inline int fctprintf(void (*out)(char character, void* arg), void* arg, Fmt format, const Args&... args)
+{
+  (void)format;
+  detail::out_fct_wrap_type out_fct_wrap = { out, arg };
+  return detail::vformat<Fmt>(detail::out_fct, reinterpret_cast<char*>(&out_fct_wrap), (std::size_t)-1, args...);
+}
+
+} // namespace printf_ct
+
+
+#endif  // _PRINTF_HPP_
@@ -33,15 +33,34 @@
 #include <string.h>
 #include <sstream>
 #include <math.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
 
 
 namespace test {
   // use functions in own test namespace to avoid stdio conflicts
   #include "../printf.h"
   #include "../printf.c"
+  #include "../printf.hpp"
 } // namespace test
 
 
+namespace test_sp {
+  // single precision build with shortest round-trip "%g", the printf.h
+  // declarations have C linkage so only the implementation is included again
+  #define PRINTF_ENABLE_SUPPORT_SINGLE_PRECISION
+  #define PRINTF_ENABLE_SUPPORT_SHORTEST_ROUNDTRIP
+  #undef FLOATING_C
+  #undef FLOATING_MAX
+  using test::printf_out_fct_type;
+  void _putchar(char character);
+  #include "../printf.c"
+} // namespace test_sp
+
+
 // dummy putchar
 static char   printf_buffer[100];
 static size_t printf_idx = 0U;
@@ -51,6 +70,11 @@ void test::_putchar(char character)
   printf_buffer[printf_idx++] = character;
 }
 
+void test_sp::_putchar(char character)
+{
+  (void)character;
+}
+
 void _out_fct(char character, void* arg)
 {
   (void)arg;
@@ -1239,6 +1263,210 @@ TEST_CASE("float", "[]" ) {
 }
 
 
+TEST_CASE("single precision float", "[]" ) {
+  char buffer[100];
+
+  test_sp::sprintf(buffer, "%8f", NAN);
+  REQUIRE(!strcmp(buffer, "     nan"));
+
+  test_sp::sprintf(buffer, "%-8f", -INFINITY);
+  REQUIRE(!strcmp(buffer, "-inf    "));
+
+  test_sp::sprintf(buffer, "%.4f", 3.1415354);
+  REQUIRE(!strcmp(buffer, "3.1415"));
+
+  test_sp::sprintf(buffer, "%.3f", 30343.1415354);
+  REQUIRE(!strcmp(buffer, "30343.141"));
+
+  test_sp::sprintf(buffer, "%.0f", 1.55);
+  REQUIRE(!strcmp(buffer, "2"));
+
+  test_sp::sprintf(buffer, "%+6.2f", 42.8952);
+  REQUIRE(!strcmp(buffer, "+42.90"));
+
+  test_sp::sprintf(buffer, "%e", 0.0);
+  REQUIRE(!strcmp(buffer, "0.000000e+00"));
+
+  test_sp::sprintf(buffer, "%.3e", 1.17549435e-38);
+  REQUIRE(!strcmp(buffer, "1.175e-38"));
+
+  test_sp::sprintf(buffer, "%.3e", 3.0e38);
+  REQUIRE(!strcmp(buffer, "3.000e+38"));
+
+  test_sp::sprintf(buffer, "%.5G", 123456789.);
+  REQUIRE(!strcmp(buffer, "1.2346E+08"));
+
+  // doubles out of the float range saturate
+  test_sp::sprintf(buffer, "%e", 1e300);
+  REQUIRE(!strcmp(buffer, "inf"));
+
+  // brute force against the standard library, limited to the float precision
+  bool fail = false;
+  std::stringstream str;
+  str.precision(4);
+  for (float i = -100000; i < 100000; i += 1) {
+    test_sp::sprintf(buffer, "%.4f", (double)(i / 10000));
+    str.str("");
+    str << std::fixed << i / 10000;
+    fail = fail || !!strcmp(buffer, str.str().c_str());
+  }
+  REQUIRE(!fail);
+
+  // float has ~7 significant digits, so allow one unit in the last printed digit
+  for (float i = -1e20f; i < 1e20f; i += 1e15f) {
+    test_sp::sprintf(buffer, "%.5e", (double)i);
+    const double value = strtod(buffer, NULL);
+    fail = fail || (fabs(value - (double)i) > fabs((double)i) * 1e-5);
+  }
+  REQUIRE(!fail);
+}
+
+
+// count the digits between the first and the last non-zero digit of the mantissa
+static int significant_digits(const char* str)
+{
+  const char* first = NULL;
+  const char* last  = NULL;
+  for (; *str && (*str != 'e') && (*str != 'E'); str++) {
+    if ((*str >= '1') && (*str <= '9')) {
+      first = first ? first : str;
+      last  = str;
+    }
+  }
+  int digits = 0;
+  for (const char* p = first; p && (p <= last); p++) {
+    digits += (*p >= '0') && (*p <= '9');
+  }
+  return digits;
+}
+
+
+TEST_CASE("shortest round-trip", "[]" ) {
+  char buffer[100];
+
+  test_sp::sprintf(buffer, "%g", 0.0);
+  REQUIRE(!strcmp(buffer, "0"));
+
+  test_sp::sprintf(buffer, "%g", 0.1);
+  REQUIRE(!strcmp(buffer, "0.1"));
+
+  test_sp::sprintf(buffer, "%g", -2.5e-7);
+  REQUIRE(!strcmp(buffer, "-2.5e-07"));
+
+  test_sp::sprintf(buffer, "%g", 100.0);
+  REQUIRE(!strcmp(buffer, "100"));
+
+  test_sp::sprintf(buffer, "%g", 1234567.0);
+  REQUIRE(!strcmp(buffer, "1.234567e+06"));
+
+  test_sp::sprintf(buffer, "%G", 3.14159265);
+  REQUIRE(!strcmp(buffer, "3.1415927"));
+
+  test_sp::sprintf(buffer, "%g", 0.00012);
+  REQUIRE(!strcmp(buffer, "0.00012"));
+
+  test_sp::sprintf(buffer, "%g", 1.4e-45);
+  REQUIRE(!strcmp(buffer, "1e-45"));
+
+  test_sp::sprintf(buffer, "%+08g", 12.5);
+  REQUIRE(!strcmp(buffer, "+00012.5"));
+
+  test_sp::sprintf(buffer, "%-8g|", 12.5);
+  REQUIRE(!strcmp(buffer, "12.5    |"));
+
+  // an explicit precision keeps the classic "%g" behavior
+  test_sp::sprintf(buffer, "%.3g", 3.14159265);
+  REQUIRE(!strcmp(buffer, "3.14"));
+
+  // random floats: the output must parse back to the same float, have the minimal
+  // number of digits and the same digits as the correctly rounded standard output
+  bool fail = false;
+  std::stringstream reference, digits;
+  reference.setf(std::ios::scientific, std::ios::floatfield);
+  digits.setf(std::ios::scientific, std::ios::floatfield);
+  uint32_t seed = 0x2545F491U;
+  for (long n = 0; n < 2000000L; n++) {
+    seed ^= seed << 13U; seed ^= seed >> 17U; seed ^= seed << 5U;
+    float value;
+    memcpy(&value, &seed, sizeof(value));
+    if ((value != value) || isinf(value) || (value == 0.0f)) {
+      continue;
+    }
+    test_sp::sprintf(buffer, "%g", (double)value);
+
+    int prec = 1;
+    for (; prec < 9; prec++) {
+      reference.str("");
+      reference.precision(prec - 1);
+      reference << (double)value;
+      if (strtof(reference.str().c_str(), NULL) == value) {
+        break;
+      }
+    }
+    reference.str("");
+    reference.precision(prec - 1);
+    reference << (double)value;
+    digits.str("");
+    digits.precision(prec - 1);
+    digits << strtod(buffer, NULL);
+
+    fail = fail || (strtof(buffer, NULL) != value);
+    fail = fail || (significant_digits(buffer) > prec);
+    fail = fail || (reference.str() != digits.str());
+  }
+  REQUIRE(!fail);
+}
+
+
+// the compile-time front end must produce the same output as the runtime parser
+#define REQUIRE_SAME_FORMAT(fmt, ...)                                                 \
+  do {                                                                                \
+    char expected[100];                                                               \
+    const int ret = test::snprintf(expected, sizeof(expected), fmt, __VA_ARGS__);     \
+    REQUIRE(test::printf_ct::snprintf_(buffer, sizeof(buffer), PRINTF_FMT(fmt), __VA_ARGS__) == ret); \
+    REQUIRE(!strcmp(buffer, expected));                                               \
+  } while (0)
+
+TEST_CASE("compile-time format", "[]" ) {
+  char buffer[100];
+
+  REQUIRE(test::printf_ct::snprintf_(buffer, sizeof(buffer), PRINTF_FMT("no conversion")) == 13);
+  REQUIRE(!strcmp(buffer, "no conversion"));
+
+  REQUIRE(test::printf_ct::snprintf_(buffer, sizeof(buffer), PRINTF_FMT("100%%")) == 4);
+  REQUIRE(!strcmp(buffer, "100%"));
+
+  REQUIRE_SAME_FORMAT("Hour: %d, Min: %d, Sec: %d", 12, 5, 59);
+  REQUIRE_SAME_FORMAT("%02u:%02u:%02u", 7U, 8U, 9U);
+  REQUIRE_SAME_FORMAT("[%-8d|%+5d|% d|%05d]", -42, 42, 42, -42);
+  REQUIRE_SAME_FORMAT("%x %X %#x %#o %b %#b", 0xBEEFU, 0xBEEFU, 255U, 8U, 5U, 5U);
+  REQUIRE_SAME_FORMAT("%.5d %8.3d %-8.3u|", 42, -7, 7U);
+  REQUIRE_SAME_FORMAT("%hhd %hhu %hd %hu", -1, 300, 70000, 70000);
+  REQUIRE_SAME_FORMAT("%ld %lu %lx", -123456789L, 123456789UL, 0xDEADBEEFUL);
+  REQUIRE_SAME_FORMAT("%lld %llu %llX", -1234567890123LL, 18446744073709551615ULL, 0x1234567890ABCDEFULL);
+  REQUIRE_SAME_FORMAT("%zu %td %jd", (size_t)42, (ptrdiff_t)-42, (intmax_t)42);
+  REQUIRE_SAME_FORMAT("%c%c%-3c|%3c", 'a', 'b', 'c', 'd');
+  REQUIRE_SAME_FORMAT("%s|%10s|%-10s|%.3s|%.0s", "bit", "bit", "bit", "foobar", "foobar");
+  REQUIRE_SAME_FORMAT("%*d|%-*d|%*sx", 5, 42, 5, 42, -3, "hi");
+  REQUIRE_SAME_FORMAT("%.*d|%.*s", 4, 7, 2, "foobar");
+  REQUIRE_SAME_FORMAT("%p", (void*)(uintptr_t)0x1234U);
+  REQUIRE_SAME_FORMAT("%f %.3f %+8.2f %-8.1f|", 3.1415354, 30343.1415354, 42.8952, 0.5);
+  REQUIRE_SAME_FORMAT("%F %.0f", 42.5, 3.5);
+#ifndef PRINTF_DISABLE_SUPPORT_EXPONENTIAL
+  REQUIRE_SAME_FORMAT("%e %E %.3g %G %+012.4g", 12345.678, 0.00012, 3.14159, 12345.678, 0.00001234);
+#endif
+
+  // output function and truncation
+  printf_idx = 0U;
+  memset(printf_buffer, 0xCC, 100U);
+  REQUIRE(test::printf_ct::fctprintf(&_out_fct, nullptr, PRINTF_FMT("This is a test of %X"), 0x12EFU) == 22);
+  REQUIRE(!strncmp(printf_buffer, "This is a test of 12EF", 22U));
+
+  REQUIRE(test::printf_ct::snprintf_(buffer, 5U, PRINTF_FMT("%d-%s"), 1234, "567") == 8);
+  REQUIRE(!strcmp(buffer, "1234"));
+}
+
+
 TEST_CASE("types", "[]" ) {
   char buffer[100];
 